@@ -0,0 +1,191 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HoodAnimBenchmarkCommandlet.h"
+#include "HoodAnimBudgetComponent.h"
+#include "HoodFrameArena.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogHoodAnimBenchmark, Log, All);
+
+/** Fixed step so every pass simulates the same game time */
+static const float BenchmarkDeltaTime = 1.f / 60.f;
+static const int32 WarmupFrames = 30;
+/** Every guard measures its distance from here */
+static const FVector BenchmarkViewLocation(0.f, 0.f, 170.f);
+
+UHoodAnimBenchmarkCommandlet::UHoodAnimBenchmarkCommandlet()
+	: GuardClass(nullptr)
+	, NumGuards(51)
+	, NumFrames(300)
+	, bVisible(false)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UHoodAnimBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString GuardClassName(TEXT("/Game/Enemy/AI_Character.AI_Character_C"));
+	FParse::Value(*Params, TEXT("GuardClass="), GuardClassName);
+	FParse::Value(*Params, TEXT("Guards="), NumGuards);
+	FParse::Value(*Params, TEXT("Frames="), NumFrames);
+	bVisible = FParse::Param(*Params, TEXT("Visible"));
+	const bool bSingleThreaded = FParse::Param(*Params, TEXT("SingleThreaded"));
+	NumGuards = FMath::Max(NumGuards, 1);
+	NumFrames = FMath::Max(NumFrames, 1);
+
+	GuardClass = LoadClass<ACharacter>(nullptr, *GuardClassName);
+	if (GuardClass == nullptr)
+	{
+		UE_LOG(LogHoodAnimBenchmark, Error, TEXT("Couldn't load guard class %s"), *GuardClassName);
+		return 1;
+	}
+
+	IConsoleVariable* ParallelAnimUpdate = IConsoleManager::Get().FindConsoleVariable(TEXT("a.ParallelAnimUpdate"));
+	IConsoleVariable* ParallelAnimEvaluation = IConsoleManager::Get().FindConsoleVariable(TEXT("a.ParallelAnimEvaluation"));
+	const int32 OldParallelAnimUpdate = ParallelAnimUpdate != nullptr ? ParallelAnimUpdate->GetInt() : 1;
+	const int32 OldParallelAnimEvaluation = ParallelAnimEvaluation != nullptr ? ParallelAnimEvaluation->GetInt() : 1;
+	if (bSingleThreaded && ParallelAnimUpdate != nullptr && ParallelAnimEvaluation != nullptr)
+	{
+		ParallelAnimUpdate->Set(0);
+		ParallelAnimEvaluation->Set(0);
+	}
+
+	const double SleepingMs = RunPass(EPass::Sleeping);
+	const double FullRateMs = RunPass(EPass::FullRate);
+	const double BudgetMs = RunPass(EPass::Budget);
+
+	if (bSingleThreaded && ParallelAnimUpdate != nullptr && ParallelAnimEvaluation != nullptr)
+	{
+		ParallelAnimUpdate->Set(OldParallelAnimUpdate);
+		ParallelAnimEvaluation->Set(OldParallelAnimEvaluation);
+	}
+
+	if (SleepingMs < 0.0 || FullRateMs < 0.0 || BudgetMs < 0.0)
+	{
+		return 1;
+	}
+
+	const double FullRateAnimMs = FMath::Max(FullRateMs - SleepingMs, 0.0);
+	const double BudgetAnimMs = FMath::Max(BudgetMs - SleepingMs, 0.0);
+	UE_LOG(LogHoodAnimBenchmark, Display, TEXT("%d guards (rings at %.0f, %.0f and %.0f uu), %d frames, %s, %s"), NumGuards,
+		GetRingDistance(0), GetRingDistance(1), GetRingDistance(2), NumFrames,
+		bVisible ? TEXT("visible") : TEXT("not rendered"), bSingleThreaded ? TEXT("single threaded anim") : TEXT("parallel anim"));
+	UE_LOG(LogHoodAnimBenchmark, Display, TEXT("  World tick wall time: sleeping %.3f ms, full rate %.3f ms, budget %.3f ms"), SleepingMs, FullRateMs, BudgetMs);
+	UE_LOG(LogHoodAnimBenchmark, Display, TEXT("  World tick wall time over sleeping (%s): full rate %.3f ms, budget %.3f ms (%.1f%% saved)"),
+		bSingleThreaded ? TEXT("all anim work") : TEXT("game thread anim work and waits on anim tasks"),
+		FullRateAnimMs, BudgetAnimMs, FullRateAnimMs > 0.0 ? 100.0 * (1.0 - BudgetAnimMs / FullRateAnimMs) : 0.0);
+
+	return 0;
+}
+
+float UHoodAnimBenchmarkCommandlet::GetRingDistance(int32 Ring)
+{
+	const UHoodAnimBudgetComponent* DefaultBudget = GetDefault<UHoodAnimBudgetComponent>();
+	switch (Ring)
+	{
+	case 0:
+		return DefaultBudget->NearDistance * 0.5f;
+	case 1:
+		return (DefaultBudget->NearDistance + DefaultBudget->FarDistance) * 0.5f;
+	default:
+		return DefaultBudget->FarDistance * 1.5f;
+	}
+}
+
+double UHoodAnimBenchmarkCommandlet::RunPass(EPass Pass)
+{
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone();
+
+	UWorld* World = GameInstance->GetWorld();
+	const FURL URL;
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	// One ring per distance band of the budget around the view, guards dealt to the rings in turn
+	const int32 GuardsPerRing = FMath::DivideAndRoundUp(NumGuards, 3);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	TArray<ACharacter*> Guards;
+	for (int32 Index = 0; Index < NumGuards; ++Index)
+	{
+		const float Angle = 2.f * PI * (Index / 3) / GuardsPerRing;
+		const FVector Location = BenchmarkViewLocation + GetRingDistance(Index % 3) * FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f);
+		ACharacter* Guard = World->SpawnActor<ACharacter>(GuardClass, Location, FRotator::ZeroRotator, SpawnParams);
+		if (Guard == nullptr)
+		{
+			continue;
+		}
+
+		// The world has no floor, keep the guards in their ring instead of falling away from the view
+		Guard->GetCharacterMovement()->DisableMovement();
+
+		// The game mode already gave it one, add it in case the world runs another game mode
+		UHoodAnimBudgetComponent* AnimBudget = Guard->FindComponentByClass<UHoodAnimBudgetComponent>();
+		if (AnimBudget == nullptr)
+		{
+			AnimBudget = NewObject<UHoodAnimBudgetComponent>(Guard, TEXT("AnimBudget"));
+			AnimBudget->RegisterComponent();
+		}
+		// Blackboard state of the guard class must not change the pass
+		AnimBudget->SleepingBlackboardKey = NAME_None;
+		AnimBudget->SetViewLocationOverride(BenchmarkViewLocation);
+		AnimBudget->bBudgetEnabled = Pass != EPass::FullRate;
+		AnimBudget->SetSleeping(Pass == EPass::Sleeping);
+		AnimBudget->UpdateBudget();
+
+		Guards.Add(Guard);
+	}
+
+	double TotalSeconds = -1.0;
+	if (Guards.Num() == NumGuards)
+	{
+		TotalSeconds = 0.0;
+		for (int32 Frame = 0; Frame < WarmupFrames + NumFrames; ++Frame)
+		{
+			if (bVisible)
+			{
+				for (ACharacter* Guard : Guards)
+				{
+					Guard->GetMesh()->LastRenderTime = World->GetTimeSeconds();
+				}
+			}
+
+			const double StartTime = FPlatformTime::Seconds();
+			World->Tick(LEVELTICK_All, BenchmarkDeltaTime);
+			if (Frame >= WarmupFrames)
+			{
+				TotalSeconds += FPlatformTime::Seconds() - StartTime;
+			}
+
+			FHoodFrameArena::Get().Reset();
+			++GFrameCounter;
+		}
+	}
+	else
+	{
+		UE_LOG(LogHoodAnimBenchmark, Error, TEXT("Only %d of %d guards spawned"), Guards.Num(), NumGuards);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	GameInstance->RemoveFromRoot();
+	CollectGarbage(RF_NoFlags);
+
+	return TotalSeconds < 0.0 ? TotalSeconds : TotalSeconds * 1000.0 / NumFrames;
+}
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "HoodAnimBenchmarkCommandlet.generated.h"
+
+/**
+ * Headless benchmark of the animation budget: spawns N guards in an empty game world, a third of them in each
+ * distance ring of UHoodAnimBudgetComponent (near, interpolated, far) around a fixed view, and reports the world tick
+ * wall time at full rate and with the budget, minus a run where every guard sleeps (no anim tick).
+ * That difference includes the time the game thread waits for the parallel anim tasks, pass -SingleThreaded to run
+ * all the anim work on the game thread so it is the whole anim cost instead.
+ *
+ * Usage: UE4Editor-Cmd.exe HoodProject -run=HoodAnimBenchmark [-Guards=51] [-Frames=300]
+ *        [-GuardClass=/Game/Enemy/AI_Character.AI_Character_C] [-Visible] [-SingleThreaded]
+ * Nothing is rendered, so guards count as not visible unless -Visible is passed. Even then the engine sees no screen
+ * size, so the interpolated ring skips frames at the slowest interpolated rate.
+ */
+UCLASS()
+class UHoodAnimBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UHoodAnimBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	enum class EPass
+	{
+		Sleeping,
+		FullRate,
+		Budget,
+	};
+
+	/** Returns the average world tick wall time in milliseconds, or a negative value on failure */
+	double RunPass(EPass Pass);
+
+	/** Distance from the view of the guards in ring 0 (full rate), 1 (interpolated) or 2 (far) */
+	static float GetRingDistance(int32 Ring);
+
+	UClass* GuardClass;
+	int32 NumGuards;
+	int32 NumFrames;
+	bool bVisible;
+};
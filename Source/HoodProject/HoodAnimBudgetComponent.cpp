@@ -0,0 +1,202 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HoodAnimBudgetComponent.h"
+#include "HoodProject.h"
+#include "Animation/AnimInstance.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "Blueprint/AIBlueprintHelperLibrary.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogHoodAnimBudget, Log, All);
+
+UHoodAnimBudgetComponent::UHoodAnimBudgetComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UHoodAnimBudgetComponent::BeginPlay()
+{
+	HOOD_LLM_SCOPE(Anim);
+	Super::BeginPlay();
+
+	GetOwner()->GetComponents<USkeletalMeshComponent>(Meshes);
+	for (USkeletalMeshComponent* Mesh : Meshes)
+	{
+		Mesh->OnAnimUpdateRateParamsCreated.BindUObject(this, &UHoodAnimBudgetComponent::SetupUpdateRateParams);
+		if (Mesh->AnimUpdateRateParams != nullptr)
+		{
+			SetupUpdateRateParams(Mesh->AnimUpdateRateParams);
+		}
+		ReportGameThreadAnimInstance(Mesh);
+	}
+
+	SetComponentTickInterval(BudgetInterval);
+	UpdateBudget();
+}
+
+void UHoodAnimBudgetComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	for (USkeletalMeshComponent* Mesh : Meshes)
+	{
+		if (Mesh != nullptr)
+		{
+			Mesh->OnAnimUpdateRateParamsCreated.Unbind();
+		}
+	}
+	Meshes.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UHoodAnimBudgetComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	UpdateBudget();
+}
+
+void UHoodAnimBudgetComponent::SetSleeping(bool bNewSleeping)
+{
+	if (bSleeping == bNewSleeping)
+	{
+		return;
+	}
+
+	bSleeping = bNewSleeping;
+	UpdateBudget();
+}
+
+void UHoodAnimBudgetComponent::UpdateBudget()
+{
+	HOOD_LLM_SCOPE(Anim);
+
+	const bool bIsSleeping = bSleeping || IsSleepingOnBlackboard();
+
+	FVector ViewLocation;
+	const bool bHasView = GetViewLocation(ViewLocation);
+
+	UWorld* World = GetWorld();
+	const float FrameTime = World->GetDeltaSeconds();
+	// Anything rendered since the last budget tick counts as visible
+	const float RenderTolerance = BudgetInterval + 0.1f;
+
+	for (USkeletalMeshComponent* Mesh : Meshes)
+	{
+		if (Mesh == nullptr)
+		{
+			continue;
+		}
+
+		if (!bBudgetEnabled)
+		{
+			Mesh->SetComponentTickEnabled(true);
+			Mesh->SetComponentTickInterval(0.f);
+			Mesh->bEnableUpdateRateOptimizations = false;
+			continue;
+		}
+
+		// A sleeping guard holds its last pose
+		Mesh->SetComponentTickEnabled(!bIsSleeping);
+		if (bIsSleeping)
+		{
+			continue;
+		}
+
+		const bool bRendered = World->TimeSince(Mesh->LastRenderTime) <= RenderTolerance;
+		const float Distance = bHasView ? FVector::Dist(ViewLocation, Mesh->GetComponentLocation()) : BIG_NUMBER;
+
+		if (bRendered && Distance < NearDistance)
+		{
+			Mesh->SetComponentTickInterval(0.f);
+			Mesh->bEnableUpdateRateOptimizations = false;
+		}
+		else if (bRendered && Distance < FarDistance && Mesh->AnimUpdateRateParams != nullptr)
+		{
+			// Engine skips frames from the screen size and interpolates them
+			Mesh->SetComponentTickInterval(0.f);
+			Mesh->bEnableUpdateRateOptimizations = true;
+		}
+		else
+		{
+			const int32 UpdateRate = bRendered ? FarUpdateRate : NotRenderedUpdateRate;
+			// Half a frame less so the mesh doesn't drift to one more frame than asked
+			Mesh->SetComponentTickInterval(FMath::Max(UpdateRate - 0.5f, 0.f) * FrameTime);
+			Mesh->bEnableUpdateRateOptimizations = false;
+		}
+	}
+}
+
+void UHoodAnimBudgetComponent::SetupUpdateRateParams(FAnimUpdateRateParameters* Params)
+{
+	Params->bShouldUseLodMap = false;
+	Params->MaxEvalRateForInterpolation = bInterpolateSkippedFrames ? FarUpdateRate : 1;
+	Params->BaseNonRenderedUpdateRate = NotRenderedUpdateRate;
+}
+
+void UHoodAnimBudgetComponent::SetViewLocationOverride(const FVector& Location)
+{
+	bHasViewLocationOverride = true;
+	ViewLocationOverride = Location;
+}
+
+void UHoodAnimBudgetComponent::ClearViewLocationOverride()
+{
+	bHasViewLocationOverride = false;
+}
+
+bool UHoodAnimBudgetComponent::GetViewLocation(FVector& OutLocation) const
+{
+	if (bHasViewLocationOverride)
+	{
+		OutLocation = ViewLocationOverride;
+		return true;
+	}
+
+	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (PlayerController == nullptr || !PlayerController->IsLocalController())
+	{
+		return false;
+	}
+
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(OutLocation, ViewRotation);
+	return true;
+}
+
+bool UHoodAnimBudgetComponent::IsSleepingOnBlackboard() const
+{
+	if (SleepingBlackboardKey.IsNone())
+	{
+		return false;
+	}
+
+	UBlackboardComponent* Blackboard = UAIBlueprintHelperLibrary::GetBlackboard(GetOwner());
+	if (Blackboard == nullptr || Blackboard->GetKeyID(SleepingBlackboardKey) == FBlackboard::InvalidKey)
+	{
+		return false;
+	}
+
+	return Blackboard->GetValueAsBool(SleepingBlackboardKey);
+}
+
+void UHoodAnimBudgetComponent::ReportGameThreadAnimInstance(const USkeletalMeshComponent* Mesh)
+{
+	const UAnimInstance* AnimInstance = Mesh->GetAnimInstance();
+	if (AnimInstance == nullptr || AnimInstance->CanRunParallelWork())
+	{
+		return;
+	}
+
+	static TSet<FName> ReportedClasses;
+	bool bAlreadyReported = false;
+	ReportedClasses.Add(AnimInstance->GetClass()->GetFName(), &bAlreadyReported);
+	if (!bAlreadyReported)
+	{
+		UE_LOG(LogHoodAnimBudget, Warning, TEXT("%s updates on the game thread, enable Use Multi Threaded Animation Update in its class settings (first seen on %s)"),
+			*AnimInstance->GetClass()->GetName(), *Mesh->GetOwner()->GetName());
+	}
+}
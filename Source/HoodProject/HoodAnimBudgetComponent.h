@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "HoodAnimBudgetComponent.generated.h"
+
+class USkeletalMeshComponent;
+struct FAnimUpdateRateParameters;
+
+/**
+ * Throttles the animation of the owner's skeletal meshes (guards, first person arms) from their distance to the
+ * local player view and whether they were rendered recently. Sleeping guards don't tick their animation at all.
+ * The game mode adds it to every character, it can also be added by hand in a blueprint.
+ */
+UCLASS(ClassGroup = (Hood), meta = (BlueprintSpawnableComponent))
+class HOODPROJECT_API UHoodAnimBudgetComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UHoodAnimBudgetComponent();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/* Stops (or resumes) the animation of a sleeping guard */
+	UFUNCTION(BlueprintCallable, Category = "AnimBudget")
+		void SetSleeping(bool bNewSleeping);
+
+	/* Re-evaluates the update rate of every mesh now instead of waiting for the next budget tick */
+	void UpdateBudget();
+
+	/* Measures distances from this location instead of the local player view (headless runs have no player) */
+	void SetViewLocationOverride(const FVector& Location);
+	void ClearViewLocationOverride();
+
+	/* Turns the budget off, every mesh animates at full rate */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AnimBudget")
+		bool bBudgetEnabled = true;
+
+	/* Whether the guard sleeps, set through SetSleeping */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AnimBudget")
+		bool bSleeping = false;
+
+	/* Blackboard bool read every budget tick to know if an AI guard sleeps (FollowerBlackboard's Sleep). None to only use SetSleeping */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AnimBudget")
+		FName SleepingBlackboardKey = TEXT("Sleep");
+
+	/* Visible meshes closer than this animate every frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AnimBudget")
+		float NearDistance = 1500.f;
+
+	/* Visible meshes between NearDistance and this skip frames and interpolate them (engine update rate optimizations) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AnimBudget")
+		float FarDistance = 4000.f;
+
+	/* Interpolate the skipped frames of visible meshes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AnimBudget")
+		bool bInterpolateSkippedFrames = true;
+
+	/* Frames between animation updates for visible meshes further than FarDistance */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AnimBudget")
+		int32 FarUpdateRate = 4;
+
+	/* Frames between animation updates for meshes that weren't rendered recently */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AnimBudget")
+		int32 NotRenderedUpdateRate = 8;
+
+	/* Seconds between budget evaluations */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AnimBudget")
+		float BudgetInterval = 0.25f;
+
+private:
+	void SetupUpdateRateParams(FAnimUpdateRateParameters* Params);
+
+	/** Returns false when there is no local player to measure from */
+	bool GetViewLocation(FVector& OutLocation) const;
+
+	bool IsSleepingOnBlackboard() const;
+
+	/** Warns about anim blueprints that update on the game thread, once per class */
+	static void ReportGameThreadAnimInstance(const USkeletalMeshComponent* Mesh);
+
+	bool bHasViewLocationOverride = false;
+	FVector ViewLocationOverride = FVector::ZeroVector;
+
+	/** Skeletal meshes of the owner, gathered on BeginPlay */
+	UPROPERTY(Transient)
+		TArray<USkeletalMeshComponent*> Meshes;
+};
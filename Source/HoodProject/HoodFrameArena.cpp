@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HoodFrameArena.h"
+#include "HoodProject.h"
+
+FHoodFrameArena& FHoodFrameArena::Get()
+{
+	static FHoodFrameArena Arena;
+	return Arena;
+}
+
+FHoodFrameArena::FHoodFrameArena()
+	: Block(nullptr)
+	, BlockSize(0)
+	, Offset(0)
+	, OverflowBytes(0)
+	, PeakBytes(0)
+{
+	ResizeBlock(DefaultBlockSize);
+}
+
+FHoodFrameArena::~FHoodFrameArena()
+{
+	for (void* Allocation : Overflow)
+	{
+		FMemory::Free(Allocation);
+	}
+	FMemory::Free(Block);
+}
+
+void* FHoodFrameArena::Alloc(SIZE_T Size, uint32 Alignment)
+{
+	check(IsInGameThread());
+
+	const SIZE_T AlignedOffset = Align(Offset, Alignment);
+	if (AlignedOffset + Size <= BlockSize)
+	{
+		Offset = AlignedOffset + Size;
+		PeakBytes = FMath::Max(PeakBytes, GetBytesUsed());
+		return Block + AlignedOffset;
+	}
+
+	// Doesn't fit this frame, fall back to the heap until the next Reset grows the block
+	HOOD_LLM_SCOPE(FrameArena);
+	void* Result = FMemory::Malloc(Size, Alignment);
+	Overflow.Add(Result);
+	OverflowBytes += Size;
+	PeakBytes = FMath::Max(PeakBytes, GetBytesUsed());
+	return Result;
+}
+
+void FHoodFrameArena::Reset()
+{
+	check(IsInGameThread());
+
+	if (Overflow.Num() > 0)
+	{
+		for (void* Allocation : Overflow)
+		{
+			FMemory::Free(Allocation);
+		}
+		Overflow.Reset();
+		OverflowBytes = 0;
+
+		UE_LOG(LogTemp, Log, TEXT("FHoodFrameArena: growing block to %u bytes"), (uint32)PeakBytes);
+		ResizeBlock(Align(PeakBytes, 16));
+	}
+
+	Offset = 0;
+}
+
+void FHoodFrameArena::ResizeBlock(SIZE_T NewSize)
+{
+	HOOD_LLM_SCOPE(FrameArena);
+	FMemory::Free(Block);
+	Block = (uint8*)FMemory::Malloc(NewSize, 16);
+	BlockSize = NewSize;
+}
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Linear allocator for transient gameplay data that outlives the call creating it but not the frame. Data local to
+ * one function belongs on the stack.
+ * Everything allocated here is released at the start of the next frame, so pointers must not be kept across frames.
+ * Destructors are never run: only use it for types that don't own heap memory.
+ * Game thread only.
+ */
+class HOODPROJECT_API FHoodFrameArena
+{
+public:
+	/** Default size of the arena block, grown automatically if a frame needs more */
+	static const SIZE_T DefaultBlockSize = 64 * 1024;
+
+	static FHoodFrameArena& Get();
+
+	~FHoodFrameArena();
+
+	/** Returns uninitialized memory valid until the end of the current frame */
+	void* Alloc(SIZE_T Size, uint32 Alignment);
+
+	/** Constructs a T valid until the end of the current frame */
+	template<typename T, typename... ArgTypes>
+	T* New(ArgTypes&&... Args)
+	{
+		return new(Alloc(sizeof(T), alignof(T))) T(Forward<ArgTypes>(Args)...);
+	}
+
+	/** Constructs Num default-initialized Ts valid until the end of the current frame */
+	template<typename T>
+	T* NewArray(int32 Num)
+	{
+		T* Result = (T*)Alloc(sizeof(T) * Num, alignof(T));
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			new(Result + Index) T();
+		}
+		return Result;
+	}
+
+	/** Releases everything allocated this frame. Called once per frame by the module */
+	void Reset();
+
+	SIZE_T GetBytesUsed() const { return Offset + OverflowBytes; }
+	SIZE_T GetPeakBytesUsed() const { return PeakBytes; }
+
+private:
+	FHoodFrameArena();
+
+	void ResizeBlock(SIZE_T NewSize);
+
+	/** Main block, reused every frame */
+	uint8* Block;
+	SIZE_T BlockSize;
+	SIZE_T Offset;
+
+	/** Allocations that didn't fit in the block this frame. Freed on Reset, after which the block is grown to fit them */
+	TArray<void*, TInlineAllocator<8>> Overflow;
+	SIZE_T OverflowBytes;
+
+	SIZE_T PeakBytes;
+};
@@ -0,0 +1,367 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HoodInstancerCommandlet.h"
+#include "HoodProjectCharacter.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/Level.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectGlobals.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogHoodInstancer, Log, All);
+
+/** Actors sharing a key end up as instances of the same component */
+struct FHoodInstanceGroupKey
+{
+	ULevel* Level;
+	UStaticMesh* Mesh;
+	TArray<UMaterialInterface*, TInlineAllocator<4>> Materials;
+	FName CollisionProfile;
+	bool bCastShadow;
+	FIntVector Cell;
+
+	bool operator==(const FHoodInstanceGroupKey& Other) const
+	{
+		return Level == Other.Level && Mesh == Other.Mesh && Materials == Other.Materials
+			&& CollisionProfile == Other.CollisionProfile && bCastShadow == Other.bCastShadow && Cell == Other.Cell;
+	}
+
+	friend uint32 GetTypeHash(const FHoodInstanceGroupKey& Key)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Key.Level), GetTypeHash(Key.Mesh));
+		for (UMaterialInterface* Material : Key.Materials)
+		{
+			Hash = HashCombine(Hash, GetTypeHash(Material));
+		}
+		Hash = HashCombine(Hash, GetTypeHash(Key.CollisionProfile));
+		return HashCombine(Hash, GetTypeHash(Key.Cell));
+	}
+};
+
+/** Counts live actors and their components in every loaded level of the world */
+static void CountActorsAndComponents(UWorld* World, int32& OutActors, int32& OutComponents)
+{
+	OutActors = 0;
+	OutComponents = 0;
+	for (ULevel* Level : World->GetLevels())
+	{
+		for (AActor* Actor : Level->Actors)
+		{
+			if (Actor != nullptr && !Actor->IsPendingKill())
+			{
+				++OutActors;
+				OutComponents += Actor->GetComponents().Num();
+			}
+		}
+	}
+}
+
+UHoodInstancerCommandlet::UHoodInstancerCommandlet()
+	: CellSize(2000.f)
+	, MinInstances(2)
+	, bSave(false)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UHoodInstancerCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	FString MapsParam(TEXT("/Game/Nivel_1,/Game/Main"));
+	FParse::Value(*Params, TEXT("Maps="), MapsParam, false);
+
+	FString MeshesParam;
+	if (FParse::Value(*Params, TEXT("Meshes="), MeshesParam, false))
+	{
+		MeshesParam.ParseIntoArray(MeshFilters, TEXT(","));
+	}
+
+	FParse::Value(*Params, TEXT("CellSize="), CellSize);
+	FParse::Value(*Params, TEXT("MinInstances="), MinInstances);
+	CellSize = FMath::Max(CellSize, 100.f);
+	MinInstances = FMath::Max(MinInstances, 2);
+	bSave = FParse::Param(*Params, TEXT("Save"));
+
+	TArray<FString> Maps;
+	MapsParam.ParseIntoArray(Maps, TEXT(","));
+
+	int32 Failed = 0;
+	for (const FString& MapName : Maps)
+	{
+		if (!ProcessMap(MapName))
+		{
+			++Failed;
+		}
+	}
+	return Failed > 0 ? 1 : 0;
+#else
+	UE_LOG(LogHoodInstancer, Error, TEXT("HoodInstancer needs an editor build"));
+	return 1;
+#endif
+}
+
+bool UHoodInstancerCommandlet::CanInstance(const AStaticMeshActor* Actor) const
+{
+	// Blueprints (doors, furniture, pickups...) derive from it and keep their own logic
+	if (Actor->GetClass() != AStaticMeshActor::StaticClass() || Actor->IsPendingKill() || Actor->bHidden || Actor->Tags.Num() > 0)
+	{
+		return false;
+	}
+
+	if (Actor->GetAttachParentActor() != nullptr)
+	{
+		return false;
+	}
+	TArray<AActor*> AttachedActors;
+	Actor->GetAttachedActors(AttachedActors);
+	if (AttachedActors.Num() > 0)
+	{
+		return false;
+	}
+
+	const UStaticMeshComponent* Component = Actor->GetStaticMeshComponent();
+	if (Component == nullptr || Component->GetStaticMesh() == nullptr || Component->Mobility != EComponentMobility::Static)
+	{
+		return false;
+	}
+	if (Component->GetCollisionProfileName() == UCollisionProfile::CustomCollisionProfileName || HasComponentOverrides(Component))
+	{
+		return false;
+	}
+
+	// Metal props react to the player's power
+	for (int32 Index = 0; Index < Component->GetNumMaterials(); ++Index)
+	{
+		if (AHoodProjectCharacter::IsMetalMaterial(Component->GetMaterial(Index)))
+		{
+			return false;
+		}
+	}
+
+	if (MeshFilters.Num() > 0)
+	{
+		const FString MeshName = Component->GetStaticMesh()->GetName();
+		const bool bMatchesFilter = MeshFilters.ContainsByPredicate([&MeshName](const FString& Filter)
+		{
+			return MeshName.StartsWith(Filter);
+		});
+		if (!bMatchesFilter)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool UHoodInstancerCommandlet::HasComponentOverrides(const UStaticMeshComponent* Component)
+{
+	for (const FStaticMeshComponentLODInfo& LODInfo : Component->LODData)
+	{
+		if (LODInfo.OverrideVertexColors != nullptr)
+		{
+			return true;
+		}
+#if WITH_EDITORONLY_DATA
+		if (LODInfo.PaintedVertices.Num() > 0)
+		{
+			return true;
+		}
+#endif
+	}
+
+	const UStaticMeshComponent* Archetype = CastChecked<UStaticMeshComponent>(Component->GetArchetype());
+	return Component->bOverrideLightMapRes
+		|| Component->bRenderCustomDepth
+		|| Component->bGenerateOverlapEvents != Archetype->bGenerateOverlapEvents;
+}
+
+void UHoodInstancerCommandlet::FindReferencedActors(UPackage* Package, TSet<AActor*>& OutReferencedActors)
+{
+	TArray<UObject*> Objects;
+	GetObjectsWithOuter(Package, Objects, true);
+
+	TArray<UObject*> References;
+	for (UObject* Object : Objects)
+	{
+		// The level lists every actor and the world owns the level, neither is a real use
+		if (Object->IsA<ULevel>() || Object->IsA<UWorld>())
+		{
+			continue;
+		}
+
+		// An actor's components and subobjects pointing back at it don't count either
+		const AActor* Referencer = Object->IsA<AActor>() ? CastChecked<AActor>(Object) : Object->GetTypedOuter<AActor>();
+
+		References.Reset();
+		FReferenceFinder Finder(References, nullptr, false, true, false, false);
+		Finder.FindReferences(Object);
+		for (UObject* Reference : References)
+		{
+			AActor* Actor = Reference->IsA<AActor>() ? CastChecked<AActor>(Reference) : Reference->GetTypedOuter<AActor>();
+			if (Actor != nullptr && Actor != Referencer)
+			{
+				OutReferencedActors.Add(Actor);
+			}
+		}
+	}
+}
+
+#if WITH_EDITOR
+bool UHoodInstancerCommandlet::ProcessMap(const FString& MapName)
+{
+	UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+	UWorld* World = Package != nullptr ? UWorld::FindWorldInPackage(Package) : nullptr;
+	if (World == nullptr)
+	{
+		UE_LOG(LogHoodInstancer, Error, TEXT("Couldn't load map %s"), *MapName);
+		return false;
+	}
+
+	World->WorldType = EWorldType::Editor;
+	World->AddToRoot();
+	if (!World->bIsWorldInitialized)
+	{
+		World->InitWorld(UWorld::InitializationValues()
+			.AllowAudioPlayback(false)
+			.CreatePhysicsScene(false)
+			.RequiresHitProxies(false)
+			.CreateNavigation(false)
+			.CreateAISystem(false)
+			.ShouldSimulatePhysics(false)
+			.SetTransactional(false));
+	}
+	World->UpdateWorldComponents(true, false);
+
+	int32 ActorsBefore, ComponentsBefore;
+	CountActorsAndComponents(World, ActorsBefore, ComponentsBefore);
+
+	TSet<AActor*> ReferencedActors;
+	FindReferencedActors(Package, ReferencedActors);
+
+	int32 SkippedReferenced = 0;
+	TMap<FHoodInstanceGroupKey, TArray<AStaticMeshActor*>> Groups;
+	for (ULevel* Level : World->GetLevels())
+	{
+		for (AActor* Actor : Level->Actors)
+		{
+			AStaticMeshActor* MeshActor = Cast<AStaticMeshActor>(Actor);
+			if (MeshActor == nullptr || !CanInstance(MeshActor))
+			{
+				continue;
+			}
+			if (ReferencedActors.Contains(MeshActor))
+			{
+				UE_LOG(LogHoodInstancer, Log, TEXT("  Keeping %s, other objects of the map reference it"), *MeshActor->GetName());
+				++SkippedReferenced;
+				continue;
+			}
+
+			const UStaticMeshComponent* Component = MeshActor->GetStaticMeshComponent();
+			const FVector Location = Component->GetComponentLocation();
+
+			FHoodInstanceGroupKey Key;
+			Key.Level = Level;
+			Key.Mesh = Component->GetStaticMesh();
+			for (int32 Index = 0; Index < Component->GetNumMaterials(); ++Index)
+			{
+				Key.Materials.Add(Component->GetMaterial(Index));
+			}
+			Key.CollisionProfile = Component->GetCollisionProfileName();
+			Key.bCastShadow = Component->CastShadow;
+			Key.Cell = FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize));
+
+			Groups.FindOrAdd(Key).Add(MeshActor);
+		}
+	}
+
+	int32 InstancedActors = 0;
+	int32 CreatedComponents = 0;
+	for (const TPair<FHoodInstanceGroupKey, TArray<AStaticMeshActor*>>& Group : Groups)
+	{
+		const FHoodInstanceGroupKey& Key = Group.Key;
+		const TArray<AStaticMeshActor*>& Actors = Group.Value;
+		if (Actors.Num() < MinInstances)
+		{
+			continue;
+		}
+
+		const FString InstancesName = FString::Printf(TEXT("HoodInstances_%s_%d_%d_%d"), *Key.Mesh->GetName(), Key.Cell.X, Key.Cell.Y, Key.Cell.Z);
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.OverrideLevel = Key.Level;
+		SpawnParams.Name = MakeUniqueObjectName(Key.Level, AActor::StaticClass(), *InstancesName);
+		AActor* InstancesActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+
+		UHierarchicalInstancedStaticMeshComponent* Instances = NewObject<UHierarchicalInstancedStaticMeshComponent>(InstancesActor, TEXT("Instances"));
+		Instances->CreationMethod = EComponentCreationMethod::Instance;
+		Instances->SetMobility(EComponentMobility::Static);
+		Instances->SetStaticMesh(Key.Mesh);
+		for (int32 Index = 0; Index < Key.Materials.Num(); ++Index)
+		{
+			Instances->SetMaterial(Index, Key.Materials[Index]);
+		}
+		Instances->SetCollisionProfileName(Key.CollisionProfile);
+		Instances->SetCastShadow(Key.bCastShadow);
+		Instances->bGenerateOverlapEvents = Actors[0]->GetStaticMeshComponent()->bGenerateOverlapEvents;
+
+		InstancesActor->SetRootComponent(Instances);
+		InstancesActor->AddInstanceComponent(Instances);
+		InstancesActor->SetActorLocation(Actors[0]->GetActorLocation());
+		InstancesActor->SetActorLabel(InstancesName);
+		Instances->RegisterComponent();
+
+		for (AStaticMeshActor* Actor : Actors)
+		{
+			Instances->AddInstanceWorldSpace(Actor->GetStaticMeshComponent()->GetComponentTransform());
+			World->DestroyActor(Actor);
+		}
+		Instances->BuildTreeIfOutdated(false, true);
+
+		UE_LOG(LogHoodInstancer, Display, TEXT("  %s: %d actors"), *InstancesName, Actors.Num());
+		InstancedActors += Actors.Num();
+		++CreatedComponents;
+	}
+
+	int32 ActorsAfter, ComponentsAfter;
+	CountActorsAndComponents(World, ActorsAfter, ComponentsAfter);
+
+	UE_LOG(LogHoodInstancer, Display, TEXT("%s: %d actors merged into %d instanced components, %d kept because they are referenced. Actors %d -> %d, components %d -> %d"),
+		*MapName, InstancedActors, CreatedComponents, SkippedReferenced, ActorsBefore, ActorsAfter, ComponentsBefore, ComponentsAfter);
+
+	bool bSaved = true;
+	if (!bSave && CreatedComponents > 0)
+	{
+		UE_LOG(LogHoodInstancer, Display, TEXT("%s: not saved, pass -Save to write the map"), *MapName);
+	}
+	else if (bSave && CreatedComponents > 0)
+	{
+		UE_LOG(LogHoodInstancer, Display, TEXT("%s: rebuild lighting before shipping, the new components have no lightmaps yet"), *MapName);
+
+		const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetMapPackageExtension());
+		Package->MarkPackageDirty();
+		bSaved = UPackage::SavePackage(Package, World, RF_NoFlags, *Filename, GError, nullptr, false, true, SAVE_NoError);
+		if (!bSaved)
+		{
+			UE_LOG(LogHoodInstancer, Error, TEXT("Couldn't save %s"), *Filename);
+		}
+	}
+
+	World->RemoveFromRoot();
+	World->CleanupWorld();
+	CollectGarbage(RF_NoFlags);
+
+	return bSaved;
+}
+#endif
@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "HoodInstancerCommandlet.generated.h"
+
+class AStaticMeshActor;
+class UPackage;
+class UStaticMeshComponent;
+
+/**
+ * Replaces repeated static mesh actors (walls, floors, bars, columns, chains...) with one
+ * hierarchical instanced static mesh component per mesh, material set and cell.
+ * Movable actors, metal (power-interactive) props, actors referenced by anything else in the map (level script,
+ * Matinee, puzzle blueprints...) and components with per-instance overrides (painted vertex colors, lightmap
+ * resolution, custom depth, overlap events) are left alone.
+ * Maps are only written back with -Save: saving drops the baked lighting of the merged actors.
+ *
+ * Usage: UE4Editor-Cmd.exe HoodProject -run=HoodInstancer [-Maps=/Game/Nivel_1,/Game/Main] [-Meshes=Barrotes,Suelo_]
+ *        [-CellSize=2000] [-MinInstances=2] [-Save]
+ */
+UCLASS()
+class UHoodInstancerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UHoodInstancerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Instances one map, returns false if it couldn't be loaded or saved */
+	bool ProcessMap(const FString& MapName);
+
+	/** Whether the actor is a plain, static, non-interactive mesh that can become an instance */
+	bool CanInstance(const AStaticMeshActor* Actor) const;
+
+	/** Whether the component has per-instance settings a shared instanced component can't keep */
+	static bool HasComponentOverrides(const UStaticMeshComponent* Component);
+
+	/** Gathers the actors that objects of the package other than the level itself hold references to */
+	static void FindReferencedActors(UPackage* Package, TSet<AActor*>& OutReferencedActors);
+
+	/** Size of the grid cells used to split instances, so each HISM keeps usable bounds for culling */
+	float CellSize;
+
+	/** Groups smaller than this are left as actors */
+	int32 MinInstances;
+
+	/** If not empty, only meshes whose name starts with one of these are instanced */
+	TArray<FString> MeshFilters;
+
+	bool bSave;
+};
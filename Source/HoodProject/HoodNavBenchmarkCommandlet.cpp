@@ -0,0 +1,210 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HoodNavBenchmarkCommandlet.h"
+#include "HoodFrameArena.h"
+#include "HoodNavObstacleComponent.h"
+#include "HoodNavRebuildManager.h"
+#include "AI/Navigation/NavigationSystem.h"
+#include "AI/Navigation/RecastNavMesh.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogHoodNavBenchmark, Log, All);
+
+static const float BenchmarkDeltaTime = 1.f / 60.f;
+/** Frames the leaf takes to swing, like the door's timeline */
+static const int32 SwingFrames = 60;
+/** How far on each side of the closed leaf the doorway is probed */
+static const float DoorwayProbeDistance = 150.f;
+
+/** Ticks the world until Done returns true, false if it took longer than TimeoutSeconds of real time */
+template<typename PredicateType>
+static bool TickWorldUntil(UWorld* World, float TimeoutSeconds, PredicateType Done)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	while (!Done())
+	{
+		if (FPlatformTime::Seconds() - StartTime > TimeoutSeconds)
+		{
+			return false;
+		}
+
+		World->Tick(LEVELTICK_All, BenchmarkDeltaTime);
+		FHoodFrameArena::Get().Reset();
+		++GFrameCounter;
+	}
+	return true;
+}
+
+UHoodNavBenchmarkCommandlet::UHoodNavBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UHoodNavBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString MapName(TEXT("/Game/Nivel_1"));
+	FString DoorPrefix(TEXT("PrisonDoor"));
+	FString LeafName(TEXT("Prision_Door"));
+	int32 NumToggles = 10;
+	float Timeout = 5.f;
+	FParse::Value(*Params, TEXT("Map="), MapName);
+	FParse::Value(*Params, TEXT("Door="), DoorPrefix);
+	FParse::Value(*Params, TEXT("Leaf="), LeafName);
+	FParse::Value(*Params, TEXT("Toggles="), NumToggles);
+	FParse::Value(*Params, TEXT("Timeout="), Timeout);
+	NumToggles = FMath::Max(NumToggles, 1);
+
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone();
+
+	FString Error;
+	if (!GEngine->LoadMap(*GameInstance->GetWorldContext(), FURL(*MapName), nullptr, Error))
+	{
+		UE_LOG(LogHoodNavBenchmark, Error, TEXT("Couldn't load %s: %s"), *MapName, *Error);
+		GameInstance->RemoveFromRoot();
+		return 1;
+	}
+
+	UWorld* World = GameInstance->GetWorld();
+	UNavigationSystem* NavSys = World->GetNavigationSystem();
+	ARecastNavMesh* NavMesh = NavSys != nullptr ? Cast<ARecastNavMesh>(NavSys->GetMainNavData(FNavigationSystem::DontCreate)) : nullptr;
+	int32 Result = 0;
+
+	AActor* Door = nullptr;
+	for (TActorIterator<AActor> It(World); It && Door == nullptr; ++It)
+	{
+		if (It->GetClass()->GetName().StartsWith(DoorPrefix))
+		{
+			Door = *It;
+		}
+	}
+
+	UStaticMeshComponent* Leaf = nullptr;
+	if (Door != nullptr)
+	{
+		TInlineComponentArray<UStaticMeshComponent*> Meshes(Door);
+		for (UStaticMeshComponent* Mesh : Meshes)
+		{
+			if (Mesh->GetName() == LeafName)
+			{
+				Leaf = Mesh;
+			}
+		}
+	}
+
+	if (NavMesh == nullptr)
+	{
+		UE_LOG(LogHoodNavBenchmark, Error, TEXT("%s has no recast navmesh"), *MapName);
+		Result = 1;
+	}
+	else if (Door == nullptr)
+	{
+		UE_LOG(LogHoodNavBenchmark, Error, TEXT("No %s found in %s"), *DoorPrefix, *MapName);
+		Result = 1;
+	}
+	else if (Leaf == nullptr || Leaf->Mobility != EComponentMobility::Movable)
+	{
+		UE_LOG(LogHoodNavBenchmark, Error, TEXT("%s has no movable %s component"), *Door->GetName(), *LeafName);
+		Result = 1;
+	}
+	else if (!TickWorldUntil(World, 60.f, [NavSys]() { return !NavSys->IsNavigationBuildInProgress(); }))
+	{
+		UE_LOG(LogHoodNavBenchmark, Error, TEXT("Initial navmesh build didn't finish"));
+		Result = 1;
+	}
+	else
+	{
+		// The game mode adds it from its config, add it in case the map runs another game mode
+		UHoodNavObstacleComponent* Obstacle = Door->FindComponentByClass<UHoodNavObstacleComponent>();
+		if (Obstacle == nullptr)
+		{
+			Obstacle = NewObject<UHoodNavObstacleComponent>(Door, TEXT("NavObstacle"));
+			Obstacle->RegisterComponent();
+		}
+		AHoodNavRebuildManager* Manager = AHoodNavRebuildManager::Get(World);
+		TickWorldUntil(World, Timeout, [Manager, Obstacle]() { return !Manager->IsBusy() && Obstacle->IsNavigationUpToDate(); });
+		Manager->ResetStats();
+
+		// The doorway is crossed along the thin axis of the closed leaf, through its middle
+		const FBox LeafLocalBox = Leaf->CalcBounds(FTransform::Identity).GetBox();
+		const FVector LeafSize = LeafLocalBox.GetSize();
+		const FVector DoorwayNormal = Leaf->GetComponentTransform().GetUnitAxis(LeafSize.X < LeafSize.Y ? EAxis::X : EAxis::Y);
+		const FVector DoorwayCenter = Leaf->Bounds.Origin;
+		const FVector ProbeExtent(50.f, 50.f, 250.f);
+		FNavLocation ProbeStart, ProbeEnd;
+		if (!NavMesh->ProjectPoint(DoorwayCenter - DoorwayNormal * DoorwayProbeDistance, ProbeStart, ProbeExtent)
+			|| !NavMesh->ProjectPoint(DoorwayCenter + DoorwayNormal * DoorwayProbeDistance, ProbeEnd, ProbeExtent))
+		{
+			UE_LOG(LogHoodNavBenchmark, Error, TEXT("No navmesh on both sides of %s"), *Door->GetName());
+			Result = 1;
+			NumToggles = 0;
+		}
+
+		const FRotator ClosedRotation = Leaf->RelativeRotation;
+		for (int32 Toggle = 0; Toggle < NumToggles; ++Toggle)
+		{
+			const FHoodNavRebuildStats Before = Manager->GetStats();
+			const bool bOpen = Toggle % 2 == 0;
+
+			// Swing the leaf over several frames like the door's timeline does, the obstacle has to notice it settle
+			const FRotator FromRotation = Leaf->RelativeRotation;
+			const FRotator ToRotation = bOpen ? ClosedRotation + FRotator(0.f, 90.f, 0.f) : ClosedRotation;
+			int32 Frame = 0;
+			TickWorldUntil(World, Timeout, [Leaf, &Frame, &FromRotation, &ToRotation]()
+			{
+				Leaf->SetRelativeRotation(FMath::Lerp(FromRotation, ToRotation, (float)++Frame / SwingFrames));
+				return Frame >= SwingFrames;
+			});
+
+			if (!TickWorldUntil(World, Timeout, [Manager, Obstacle, &Before]()
+				{
+					return Manager->GetStats().NumUpdatesFinished > Before.NumUpdatesFinished && !Manager->IsBusy() && Obstacle->IsNavigationUpToDate();
+				}))
+			{
+				UE_LOG(LogHoodNavBenchmark, Error, TEXT("Toggle %d: tiles weren't rebuilt in %.1f s"), Toggle, Timeout);
+				Result = 1;
+				break;
+			}
+
+			const FHoodNavRebuildStats& After = Manager->GetStats();
+			const int32 NumDirtied = After.NumTilesDirtied - Before.NumTilesDirtied;
+			const int32 NumRebuilt = After.NumTilesRebuilt - Before.NumTilesRebuilt;
+			FVector HitLocation;
+			const bool bPassable = !NavMesh->Raycast(ProbeStart.Location, ProbeEnd.Location, HitLocation, NavMesh->GetDefaultQueryFilter());
+			UE_LOG(LogHoodNavBenchmark, Display, TEXT("Toggle %d (%s): %d of %d tiles rebuilt, %.2f ms from request to generation finished, doorway %s"),
+				Toggle, bOpen ? TEXT("open") : TEXT("close"), NumRebuilt, NumDirtied, After.LastLatencyMs, bPassable ? TEXT("passable") : TEXT("blocked"));
+			if (NumRebuilt == 0)
+			{
+				UE_LOG(LogHoodNavBenchmark, Error, TEXT("Toggle %d rebuilt no tile"), Toggle);
+				Result = 1;
+			}
+			if (bPassable != bOpen)
+			{
+				UE_LOG(LogHoodNavBenchmark, Error, TEXT("Toggle %d: doorway should be %s"), Toggle, bOpen ? TEXT("passable") : TEXT("blocked"));
+				Result = 1;
+			}
+		}
+
+		const FHoodNavRebuildStats& Stats = Manager->GetStats();
+		UE_LOG(LogHoodNavBenchmark, Display, TEXT("%s: %d updates, %d finished, %d tiles rebuilt of %d under the door, latency avg %.2f ms max %.2f ms"),
+			*Door->GetName(), Stats.NumUpdates, Stats.NumUpdatesFinished, Stats.NumTilesRebuilt, Stats.NumTilesDirtied,
+			Stats.NumUpdatesFinished > 0 ? Stats.TotalLatencyMs / Stats.NumUpdatesFinished : 0.0, Stats.MaxLatencyMs);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	GameInstance->RemoveFromRoot();
+	CollectGarbage(RF_NoFlags);
+
+	return Result;
+}
@@ -0,0 +1,28 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "HoodNavBenchmarkCommandlet.generated.h"
+
+/**
+ * Headless check of the localized navmesh updates: loads a map and swings a door leaf open and closed over a second,
+ * like the door's timeline, leaving the obstacle to notice it settle. For every toggle it reports how many navmesh
+ * tiles were actually replaced and the time from the update request to the navmesh generation finishing, then
+ * raycasts the navmesh through the doorway. Fails if a toggle rebuilds no tile, times out, or leaves the doorway
+ * blocked while open or passable while closed.
+ *
+ * Usage: UE4Editor-Cmd.exe HoodProject -run=HoodNavBenchmark [-Map=/Game/Nivel_1] [-Door=PrisonDoor]
+ *        [-Leaf=Prision_Door] [-Toggles=10] [-Timeout=5]
+ */
+UCLASS()
+class UHoodNavBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UHoodNavBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,147 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HoodNavObstacleComponent.h"
+#include "HoodNavRebuildManager.h"
+#include "HoodProject.h"
+#include "AI/Navigation/NavAreas/NavArea_Null.h"
+#include "AI/NavigationModifier.h"
+#include "AI/NavigationOctree.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Actor.h"
+
+UHoodNavObstacleComponent::UHoodNavObstacleComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, LastCheckedBounds(ForceInit)
+	, MovingTime(0.f)
+	, bUpdatePending(false)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	AreaClass = UNavArea_Null::StaticClass();
+
+	// Own octree element, the owner's root is no longer relevant
+	bAttachToOwnersRoot = false;
+}
+
+void UHoodNavObstacleComponent::BeginPlay()
+{
+	HOOD_LLM_SCOPE(Nav);
+	Super::BeginPlay();
+
+	// Moving collision would dirty the navmesh on every transform update, the modifier replaces it
+	TInlineComponentArray<UPrimitiveComponent*> Primitives(GetOwner());
+	for (UPrimitiveComponent* Primitive : Primitives)
+	{
+		if (IsObstaclePrimitive(Primitive) && Primitive->Mobility == EComponentMobility::Movable)
+		{
+			Primitive->SetCanEverAffectNavigation(false);
+		}
+	}
+
+	Manager = AHoodNavRebuildManager::Get(GetWorld());
+	LastCheckedBounds = CalcObstacleBounds();
+	SetComponentTickInterval(CheckInterval);
+	RefreshNavigationModifiers();
+}
+
+void UHoodNavObstacleComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const FBox CurrentBounds = CalcObstacleBounds();
+	const bool bStill = CurrentBounds.Min.Equals(LastCheckedBounds.Min, MoveTolerance) && CurrentBounds.Max.Equals(LastCheckedBounds.Max, MoveTolerance);
+	LastCheckedBounds = CurrentBounds;
+
+	if (!bStill)
+	{
+		MovingTime += DeltaTime;
+		if (MovingTime >= MaxMovingTime)
+		{
+			MovingTime = 0.f;
+			RequestUpdate();
+		}
+		return;
+	}
+
+	MovingTime = 0.f;
+	if (!CurrentBounds.Min.Equals(Bounds.Min, MoveTolerance) || !CurrentBounds.Max.Equals(Bounds.Max, MoveTolerance))
+	{
+		RequestUpdate();
+	}
+}
+
+void UHoodNavObstacleComponent::GetNavigationData(FNavigationRelevantData& Data) const
+{
+	if (Bounds.IsValid)
+	{
+		Data.Modifiers.Add(FAreaNavModifier(Bounds, FTransform::Identity, AreaClass));
+	}
+}
+
+void UHoodNavObstacleComponent::CalcAndCacheBounds() const
+{
+	Bounds = CalcObstacleBounds();
+	bBoundsInitialized = true;
+}
+
+void UHoodNavObstacleComponent::NotifyMoved()
+{
+	RequestUpdate();
+}
+
+bool UHoodNavObstacleComponent::IsNavigationUpToDate() const
+{
+	const FBox CurrentBounds = CalcObstacleBounds();
+	return !bUpdatePending && CurrentBounds.Min.Equals(Bounds.Min, MoveTolerance) && CurrentBounds.Max.Equals(Bounds.Max, MoveTolerance);
+}
+
+void UHoodNavObstacleComponent::ApplyPendingUpdate(FBox& OutOldBounds, FBox& OutNewBounds)
+{
+	HOOD_LLM_SCOPE(Nav);
+	bUpdatePending = false;
+
+	OutOldBounds = Bounds;
+	// Dirties the old and new bounds of the octree element, only the tiles under them get rebuilt
+	RefreshNavigationModifiers();
+	if (!bBoundsInitialized)
+	{
+		CalcAndCacheBounds();
+	}
+	OutNewBounds = Bounds;
+}
+
+bool UHoodNavObstacleComponent::IsObstaclePrimitive(const UPrimitiveComponent* Primitive)
+{
+	return Primitive->IsRegistered() && Primitive->IsCollisionEnabled() && Primitive->GetCollisionResponseToChannel(ECC_Pawn) == ECR_Block;
+}
+
+FBox UHoodNavObstacleComponent::CalcObstacleBounds() const
+{
+	FBox Result(ForceInit);
+
+	const AActor* Owner = GetOwner();
+	if (Owner == nullptr)
+	{
+		return Result;
+	}
+
+	TInlineComponentArray<UPrimitiveComponent*> Primitives(Owner);
+	for (const UPrimitiveComponent* Primitive : Primitives)
+	{
+		if (IsObstaclePrimitive(Primitive))
+		{
+			Result += Primitive->Bounds.GetBox();
+		}
+	}
+	return Result;
+}
+
+void UHoodNavObstacleComponent::RequestUpdate()
+{
+	if (bUpdatePending || !Manager.IsValid())
+	{
+		return;
+	}
+
+	bUpdatePending = true;
+	Manager->Enqueue(this);
+}
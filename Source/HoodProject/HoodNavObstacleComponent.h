@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AI/Navigation/NavRelevantComponent.h"
+#include "HoodNavObstacleComponent.generated.h"
+
+class AHoodNavRebuildManager;
+class UNavArea;
+class UPrimitiveComponent;
+
+/**
+ * Cuts a moving prop (prison door, bars, wardrobe, metal props) out of the navmesh as an area modifier.
+ * The prop's own movable collision stops affecting navigation, so moving it doesn't dirty the navmesh every frame:
+ * once it settles (or NotifyMoved is called) the rebuild manager dirties only the tiles under its old and new bounds.
+ */
+UCLASS(ClassGroup = (Hood), meta = (BlueprintSpawnableComponent))
+class HOODPROJECT_API UHoodNavObstacleComponent : public UNavRelevantComponent
+{
+	GENERATED_BODY()
+
+public:
+	UHoodNavObstacleComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	virtual void BeginPlay() override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// INavRelevantInterface
+	virtual void GetNavigationData(FNavigationRelevantData& Data) const override;
+	virtual void CalcAndCacheBounds() const override;
+
+	/* Queues a navmesh update right away, e.g. when bars are raised */
+	UFUNCTION(BlueprintCallable, Category = "Navigation")
+		void NotifyMoved();
+
+	/** True once the area cut out matches where the obstacle is and no update is waiting */
+	bool IsNavigationUpToDate() const;
+
+	/** Called by the rebuild manager when it's this obstacle's turn. Outputs the bounds cut out before and after */
+	void ApplyPendingUpdate(FBox& OutOldBounds, FBox& OutNewBounds);
+
+	/* Area applied under the obstacle */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation")
+		TSubclassOf<UNavArea> AreaClass;
+
+	/* Bounds changes smaller than this (in cm) are ignored */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation")
+		float MoveTolerance = 10.f;
+
+	/* Seconds between movement checks */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation")
+		float CheckInterval = 0.1f;
+
+	/* An obstacle that keeps moving still updates the navmesh this often */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation")
+		float MaxMovingTime = 1.f;
+
+private:
+	/** Primitives that block pawns, they make up the obstacle */
+	static bool IsObstaclePrimitive(const UPrimitiveComponent* Primitive);
+
+	FBox CalcObstacleBounds() const;
+
+	void RequestUpdate();
+
+	TWeakObjectPtr<AHoodNavRebuildManager> Manager;
+
+	FBox LastCheckedBounds;
+	float MovingTime;
+	bool bUpdatePending;
+};
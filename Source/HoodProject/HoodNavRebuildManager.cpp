@@ -0,0 +1,224 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HoodNavRebuildManager.h"
+#include "HoodNavObstacleComponent.h"
+#include "HoodProject.h"
+#include "AI/Navigation/NavigationSystem.h"
+#include "AI/Navigation/RecastNavMesh.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformTime.h"
+#if WITH_RECAST
+#include "Detour/DetourNavMesh.h"
+#endif
+
+AHoodNavRebuildManager::AHoodNavRebuildManager()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	// Obstacles tick earlier in the frame, their requests go out the same frame
+	PrimaryActorTick.TickGroup = TG_PostPhysics;
+}
+
+AHoodNavRebuildManager* AHoodNavRebuildManager::Get(UWorld* World)
+{
+	for (TActorIterator<AHoodNavRebuildManager> It(World); It; ++It)
+	{
+		return *It;
+	}
+
+	HOOD_LLM_SCOPE(Nav);
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	return World->SpawnActor<AHoodNavRebuildManager>(SpawnParams);
+}
+
+void AHoodNavRebuildManager::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UNavigationSystem* NavSys = GetWorld()->GetNavigationSystem();
+	if (NavSys != nullptr)
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &AHoodNavRebuildManager::OnNavigationGenerationFinished);
+	}
+}
+
+void AHoodNavRebuildManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UNavigationSystem* NavSys = GetWorld()->GetNavigationSystem();
+	if (NavSys != nullptr)
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &AHoodNavRebuildManager::OnNavigationGenerationFinished);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AHoodNavRebuildManager::Enqueue(UHoodNavObstacleComponent* Obstacle)
+{
+	HOOD_LLM_SCOPE(Nav);
+	FPendingUpdate Update;
+	Update.Obstacle = Obstacle;
+	Update.RequestTime = FPlatformTime::Seconds();
+	Pending.Add(Update);
+}
+
+void AHoodNavRebuildManager::Tick(float DeltaSeconds)
+{
+	HOOD_LLM_SCOPE(Nav);
+	Super::Tick(DeltaSeconds);
+
+	ARecastNavMesh* NavMesh = GetNavMesh();
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 TilesThisTick = 0;
+	int32 NumApplied = 0;
+	while (NumApplied < Pending.Num())
+	{
+		if (TilesThisTick >= MaxDirtyTilesPerTick || (FPlatformTime::Seconds() - StartTime) * 1000.0 >= TickBudgetMs)
+		{
+			break;
+		}
+
+		const FPendingUpdate& PendingUpdate = Pending[NumApplied++];
+		UHoodNavObstacleComponent* Obstacle = PendingUpdate.Obstacle.Get();
+		if (Obstacle == nullptr)
+		{
+			continue;
+		}
+
+		// Tiles are tracked before the octree update can reach the generator
+		FBox OldBounds(ForceInit);
+		FBox NewBounds(ForceInit);
+		Obstacle->ApplyPendingUpdate(OldBounds, NewBounds);
+
+		FInFlightUpdate& Update = InFlight[InFlight.AddDefaulted()];
+		Update.RequestTime = PendingUpdate.RequestTime;
+		Update.AppliedFrame = GFrameCounter;
+		TrackTiles(NavMesh, OldBounds, NewBounds, Update.Tiles);
+
+		TilesThisTick += Update.Tiles.Num();
+		Stats.NumTilesDirtied += Update.Tiles.Num();
+		++Stats.NumUpdates;
+	}
+	Pending.RemoveAt(0, NumApplied, false);
+
+	// The dirty areas only reach the generator in the navigation system tick, nothing can be rebuilt yet
+	if (NumApplied > 0)
+	{
+		return;
+	}
+
+	// OnNavigationGenerationFinished normally finishes the updates. Once the generator is idle, also finish the ones
+	// fully rebuilt and the ones over no existing tile, no generation may ever follow those
+	UNavigationSystem* NavSys = GetWorld()->GetNavigationSystem();
+	if (InFlight.Num() > 0 && NavSys != nullptr && !NavSys->IsNavigationBuildInProgress())
+	{
+		FinishRebuiltUpdates(NavMesh, false);
+	}
+}
+
+void AHoodNavRebuildManager::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+	ARecastNavMesh* NavMesh = GetNavMesh();
+	if (NavData == NavMesh && InFlight.Num() > 0)
+	{
+		FinishRebuiltUpdates(NavMesh, true);
+	}
+}
+
+void AHoodNavRebuildManager::FinishRebuiltUpdates(ARecastNavMesh* NavMesh, bool bGenerationFinished)
+{
+	const double EndTime = FPlatformTime::Seconds();
+	for (int32 Index = InFlight.Num() - 1; Index >= 0; --Index)
+	{
+		const FInFlightUpdate& Update = InFlight[Index];
+		if (Update.AppliedFrame == GFrameCounter)
+		{
+			continue;
+		}
+
+		// A generation finishing may be an earlier build, this update is part of it only if some of its tiles changed
+		const int32 NumRebuilt = CountRebuiltTiles(NavMesh, Update.Tiles);
+		const bool bFinished = Update.Tiles.Num() == 0 || (bGenerationFinished ? NumRebuilt > 0 : NumRebuilt == Update.Tiles.Num());
+		if (!bFinished)
+		{
+			continue;
+		}
+
+		Stats.NumTilesRebuilt += NumRebuilt;
+		Stats.LastLatencyMs = (EndTime - Update.RequestTime) * 1000.0;
+		Stats.MaxLatencyMs = FMath::Max(Stats.MaxLatencyMs, Stats.LastLatencyMs);
+		Stats.TotalLatencyMs += Stats.LastLatencyMs;
+		++Stats.NumUpdatesFinished;
+		InFlight.RemoveAt(Index, 1, false);
+	}
+}
+
+void AHoodNavRebuildManager::TrackTiles(ARecastNavMesh* NavMesh, const FBox& OldBounds, const FBox& NewBounds, TArray<FTrackedTile>& OutTiles) const
+{
+	OutTiles.Reset();
+#if WITH_RECAST
+	const dtNavMesh* DetourMesh = NavMesh != nullptr ? NavMesh->GetRecastMesh() : nullptr;
+	if (DetourMesh == nullptr)
+	{
+		return;
+	}
+
+	TileQueryBounds.Reset();
+	if (OldBounds.IsValid)
+	{
+		TileQueryBounds.Add(OldBounds);
+	}
+	if (NewBounds.IsValid)
+	{
+		TileQueryBounds.Add(NewBounds);
+	}
+
+	TileIndices.Reset();
+	NavMesh->GetNavMeshTilesIn(TileQueryBounds, TileIndices);
+	for (const int32 TileIndex : TileIndices)
+	{
+		const dtMeshTile* Tile = DetourMesh->getTile(TileIndex);
+		if (Tile == nullptr || Tile->header == nullptr)
+		{
+			continue;
+		}
+
+		FTrackedTile TrackedTile;
+		TrackedTile.X = Tile->header->x;
+		TrackedTile.Y = Tile->header->y;
+		TrackedTile.Layer = Tile->header->layer;
+		TrackedTile.TileRef = DetourMesh->getTileRef(Tile);
+		OutTiles.Add(TrackedTile);
+	}
+#endif
+}
+
+int32 AHoodNavRebuildManager::CountRebuiltTiles(ARecastNavMesh* NavMesh, const TArray<FTrackedTile>& Tiles)
+{
+	int32 NumRebuilt = 0;
+#if WITH_RECAST
+	const dtNavMesh* DetourMesh = NavMesh != nullptr ? NavMesh->GetRecastMesh() : nullptr;
+	if (DetourMesh == nullptr)
+	{
+		return 0;
+	}
+
+	// A rebuilt tile is removed and added again, which bumps the salt in its ref even if it lands in the same slot
+	for (const FTrackedTile& Tile : Tiles)
+	{
+		if (DetourMesh->getTileRefAt(Tile.X, Tile.Y, Tile.Layer) != Tile.TileRef)
+		{
+			++NumRebuilt;
+		}
+	}
+#endif
+	return NumRebuilt;
+}
+
+ARecastNavMesh* AHoodNavRebuildManager::GetNavMesh() const
+{
+	UNavigationSystem* NavSys = GetWorld()->GetNavigationSystem();
+	return NavSys != nullptr ? Cast<ARecastNavMesh>(NavSys->GetMainNavData(FNavigationSystem::DontCreate)) : nullptr;
+}
@@ -0,0 +1,111 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "HoodNavRebuildManager.generated.h"
+
+class ANavigationData;
+class ARecastNavMesh;
+class UHoodNavObstacleComponent;
+
+/** Counters of the localized navmesh updates, read by the HoodNavBenchmark commandlet */
+struct FHoodNavRebuildStats
+{
+	/** Obstacle updates applied */
+	int32 NumUpdates = 0;
+	/** Applied updates whose tiles the navmesh finished rebuilding */
+	int32 NumUpdatesFinished = 0;
+	/** Navmesh tiles under the old and new bounds of the applied updates */
+	int32 NumTilesDirtied = 0;
+	/** Of those, tiles the navmesh actually replaced with a rebuilt one */
+	int32 NumTilesRebuilt = 0;
+	/** From the obstacle asking for an update to the navmesh generation finishing */
+	double LastLatencyMs = 0.0;
+	double MaxLatencyMs = 0.0;
+	double TotalLatencyMs = 0.0;
+};
+
+/**
+ * Applies queued nav obstacle updates within a per-tick budget and follows them until the engine has rebuilt their
+ * tiles asynchronously. Guard paths crossing rebuilt tiles are invalidated and repathed by the navmesh itself.
+ * One per world, spawned on demand.
+ */
+UCLASS(notplaceable, transient)
+class HOODPROJECT_API AHoodNavRebuildManager : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AHoodNavRebuildManager();
+
+	/** Returns the manager of the world, spawning it if needed */
+	static AHoodNavRebuildManager* Get(UWorld* World);
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Tick(float DeltaSeconds) override;
+
+	void Enqueue(UHoodNavObstacleComponent* Obstacle);
+
+	const FHoodNavRebuildStats& GetStats() const { return Stats; }
+	void ResetStats() { Stats = FHoodNavRebuildStats(); }
+
+	/** True while updates are queued or their tiles are still being rebuilt */
+	bool IsBusy() const { return Pending.Num() > 0 || InFlight.Num() > 0; }
+
+	/* Tiles dirtied per tick at most (an update bigger than this still goes through alone) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation")
+		int32 MaxDirtyTilesPerTick = 8;
+
+	/* Game thread milliseconds spent applying updates per tick */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Navigation")
+		float TickBudgetMs = 0.5f;
+
+private:
+	struct FPendingUpdate
+	{
+		TWeakObjectPtr<UHoodNavObstacleComponent> Obstacle;
+		double RequestTime;
+	};
+
+	/** A navmesh tile slot and the tile that was in it when the update was applied */
+	struct FTrackedTile
+	{
+		int32 X;
+		int32 Y;
+		int32 Layer;
+		uint64 TileRef;
+	};
+
+	struct FInFlightUpdate
+	{
+		double RequestTime;
+		uint64 AppliedFrame;
+		TArray<FTrackedTile> Tiles;
+	};
+
+	UFUNCTION()
+		void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+	/** Remembers the tiles under the bounds, an update is done once the navmesh replaced them */
+	void TrackTiles(ARecastNavMesh* NavMesh, const FBox& OldBounds, const FBox& NewBounds, TArray<FTrackedTile>& OutTiles) const;
+
+	/** Returns how many of the tracked tiles were replaced since TrackTiles */
+	static int32 CountRebuiltTiles(ARecastNavMesh* NavMesh, const TArray<FTrackedTile>& Tiles);
+
+	/** Finishes the in flight updates whose tiles were rebuilt, all of their tiles unless bGenerationFinished */
+	void FinishRebuiltUpdates(ARecastNavMesh* NavMesh, bool bGenerationFinished);
+
+	ARecastNavMesh* GetNavMesh() const;
+
+	TArray<FPendingUpdate> Pending;
+	TArray<FInFlightUpdate> InFlight;
+
+	/** Scratch for TrackTiles */
+	mutable TArray<FBox> TileQueryBounds;
+	mutable TArray<int32> TileIndices;
+
+	FHoodNavRebuildStats Stats;
+};
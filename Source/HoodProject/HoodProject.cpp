@@ -1,7 +1,51 @@
 // Copyright 1998-2017 Epic Games, Inc. All Rights Reserved.
 
 #include "HoodProject.h"
+#include "HoodFrameArena.h"
+#include "Misc/CoreDelegates.h"
 #include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, HoodProject, "HoodProject" );
- 
\ No newline at end of file
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+DECLARE_LLM_MEMORY_STAT(TEXT("HoodProject"), STAT_HoodSummaryLLM, STATGROUP_LLM);
+DECLARE_LLM_MEMORY_STAT(TEXT("Hood Gameplay"), STAT_HoodGameplayLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("Hood Power"), STAT_HoodPowerLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("Hood FrameArena"), STAT_HoodFrameArenaLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("Hood Anim"), STAT_HoodAnimLLM, STATGROUP_LLMFULL);
+DECLARE_LLM_MEMORY_STAT(TEXT("Hood Nav"), STAT_HoodNavLLM, STATGROUP_LLMFULL);
+#endif
+
+class FHoodProjectModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+		FLowLevelMemTracker& Tracker = FLowLevelMemTracker::Get();
+		Tracker.RegisterProjectTag((int32)EHoodLLMTag::Gameplay, TEXT("HoodGameplay"), GET_STATFNAME(STAT_HoodGameplayLLM), GET_STATFNAME(STAT_HoodSummaryLLM));
+		Tracker.RegisterProjectTag((int32)EHoodLLMTag::Power, TEXT("HoodPower"), GET_STATFNAME(STAT_HoodPowerLLM), GET_STATFNAME(STAT_HoodSummaryLLM));
+		Tracker.RegisterProjectTag((int32)EHoodLLMTag::FrameArena, TEXT("HoodFrameArena"), GET_STATFNAME(STAT_HoodFrameArenaLLM), GET_STATFNAME(STAT_HoodSummaryLLM));
+		Tracker.RegisterProjectTag((int32)EHoodLLMTag::Anim, TEXT("HoodAnim"), GET_STATFNAME(STAT_HoodAnimLLM), GET_STATFNAME(STAT_HoodSummaryLLM));
+		Tracker.RegisterProjectTag((int32)EHoodLLMTag::Nav, TEXT("HoodNav"), GET_STATFNAME(STAT_HoodNavLLM), GET_STATFNAME(STAT_HoodSummaryLLM));
+#endif
+
+		HOOD_LLM_SCOPE(FrameArena);
+		FHoodFrameArena::Get();
+		BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddStatic(&FHoodProjectModule::OnBeginFrame);
+	}
+
+	virtual void ShutdownModule() override
+	{
+		FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+	}
+
+private:
+	static void OnBeginFrame()
+	{
+		FHoodFrameArena::Get().Reset();
+	}
+
+	FDelegateHandle BeginFrameHandle;
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FHoodProjectModule, HoodProject, "HoodProject" );
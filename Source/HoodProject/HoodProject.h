@@ -3,3 +3,29 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+
+/** Low-Level Memory Tracker tags owned by HoodProject, shown per subsystem in "stat LLMFULL" and as a total in "stat LLM" */
+enum class EHoodLLMTag : LLM_TAG_TYPE
+{
+	Gameplay = (LLM_TAG_TYPE)ELLMTag::ProjectTagStart,
+	Power,
+	FrameArena,
+	Anim,
+	Nav,
+
+	Count
+};
+
+static_assert((int32)EHoodLLMTag::Count <= (int32)ELLMTag::ProjectTagEnd, "Too many HoodProject LLM tags");
+
+/** Tags every allocation made in the current scope with one of the HoodProject LLM tags */
+#define HOOD_LLM_SCOPE(Tag) LLM_SCOPE((ELLMTag)EHoodLLMTag::Tag)
+
+#else
+
+#define HOOD_LLM_SCOPE(Tag)
+
+#endif
@@ -1,6 +1,7 @@
 // Copyright 1998-2017 Epic Games, Inc. All Rights Reserved.
 
 #include "HoodProjectCharacter.h"
+#include "HoodProject.h"
 #include "HoodProjectProjectile.h"
 #include "Animation/AnimInstance.h"
 #include "Camera/CameraComponent.h"
@@ -15,11 +16,14 @@
 
 DEFINE_LOG_CATEGORY_STATIC(LogFPChar, Warning, All);
 
+static const FName KeysName(TEXT("Keys"));
+
 //////////////////////////////////////////////////////////////////////////
 // AHoodProjectCharacter
 
 AHoodProjectCharacter::AHoodProjectCharacter()
 {
+	HOOD_LLM_SCOPE(Gameplay);
 
 	PrimaryActorTick.bCanEverTick = true; //Activa la funcion tick (update)
 
@@ -55,6 +59,7 @@ AHoodProjectCharacter::AHoodProjectCharacter()
 
 void AHoodProjectCharacter::BeginPlay()
 {
+	HOOD_LLM_SCOPE(Gameplay);
 	// Call the base class  
 	Super::BeginPlay();
 }
@@ -62,19 +67,21 @@ void AHoodProjectCharacter::BeginPlay()
 //////////////////////////////////////////////////////////////////////////
 // Update
 void AHoodProjectCharacter::Tick(float DeltaTime) {
+	HOOD_LLM_SCOPE(Gameplay);
 	Super::Tick(DeltaTime); // Call parent class tick function  
 
 							//if (activePowerPressed) ActivePower();
-	if (lastObjectOutlined != nullptr) {
-		if (lastObjectOutlined->GetActor()->GetName().Equals("Keys")) {
-			Cast<UPrimitiveComponent>(lastObjectOutlined->GetActor()->GetAttachParentActor()->GetRootComponent())->SetRenderCustomDepth(false);
+	//Cambiar el custom depth recrea el proxy de render, solo se toca cuando cambia el objeto
+	UPrimitiveComponent* objectOutlined = ActivePower();
+	if (lastObjectOutlined.Get() != objectOutlined) {
+		if (lastObjectOutlined.IsValid()) {
+			lastObjectOutlined->SetRenderCustomDepth(false);
 		}
-		else {
-			lastObjectOutlined->GetComponent()->SetRenderCustomDepth(false);
+		if (objectOutlined != nullptr) {
+			objectOutlined->SetRenderCustomDepth(true);
 		}
-		lastObjectOutlined = nullptr;
+		lastObjectOutlined = objectOutlined;
 	}
-	lastObjectOutlined = ActivePower();
 
 }
 
@@ -82,9 +89,9 @@ void AHoodProjectCharacter::NotifyActorBeginOverlap(AActor* other) {
 	/*static ConstructorHelpers::FObjectFinder<USoundBase> Soundf(TEXT("/Musica/llaveColision_snd"));
 	USoundBase* snd_key = Soundf.Object;
 	UGameplayStatics::PlaySound2D(this, snd_key);*/
-	if (other->GetName().Equals("Keys")) {
-		if (lastObjectOutlined != nullptr) {
-			if (lastObjectOutlined->GetActor()->GetName().Equals("Keys")) lastObjectOutlined = nullptr;
+	if (other->GetFName() == KeysName) {
+		if (lastObjectOutlined.IsValid()) {
+			if (lastObjectOutlined->GetOwner() == other->GetAttachParentActor()) lastObjectOutlined = nullptr;
 		}
 		other->GetAttachParentActor()->Destroy();
 		other->Destroy();
@@ -242,40 +249,47 @@ void AHoodProjectCharacter::Crouch() {
 	}
 }
 
-FHitResult* AHoodProjectCharacter::ActivePower() {
+/** Checks the material name for "Metal" without building an FString every frame */
+bool AHoodProjectCharacter::IsMetalMaterial(const UMaterialInterface* material) {
+	if (material == nullptr) return false;
+	const FNameEntry* nameEntry = material->GetFName().GetDisplayNameEntry();
+	return nameEntry->IsWide() ? FCStringWide::Stristr(nameEntry->GetWideName(), L"Metal") != nullptr
+		: FCStringAnsi::Stristr(nameEntry->GetAnsiName(), "Metal") != nullptr;
+}
+
+UPrimitiveComponent* AHoodProjectCharacter::ActivePower() {
+	HOOD_LLM_SCOPE(Power);
 
-	FHitResult* hitResult = new FHitResult();
+	FHitResult hitResult;
 
 	FVector start = FirstPersonCameraComponent->GetComponentLocation();
 	FVector forward = FirstPersonCameraComponent->GetForwardVector();
 	FVector end = start + (forward * distancePower); //Distancia de efecto del poder
-	FCollisionQueryParams* params = new FCollisionQueryParams();
+	FCollisionQueryParams params;
 
-	bool hitMetalObject = false;
+	UPrimitiveComponent* hitMetalObject = nullptr;
 
-	if (GetWorld()->LineTraceSingleByChannel(*hitResult, start, end, ECC_Visibility, *params)) {
+	if (GetWorld()->LineTraceSingleByChannel(hitResult, start, end, ECC_Visibility, params)) {
 		/*DrawDebugLine(GetWorld(), start, end, FColor::Red, true);
-		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::Printf(TEXT("Hit: %s"), *hitResult->Actor->GetName()));*/
-		if (hitResult->GetActor()->GetName().Equals("Keys")) {
-			Cast<UPrimitiveComponent>(hitResult->GetActor()->GetAttachParentActor()->GetRootComponent())->SetRenderCustomDepth(true);
-			hitMetalObject = true;
+		GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, FString::Printf(TEXT("Hit: %s"), *hitResult.Actor->GetName()));*/
+		if (hitResult.GetActor()->GetFName() == KeysName) {
+			UPrimitiveComponent* keysRoot = Cast<UPrimitiveComponent>(hitResult.GetActor()->GetAttachParentActor()->GetRootComponent());
+			hitMetalObject = keysRoot;
 			if (activePowerPressed && power > 0) {
-				Cast<UPrimitiveComponent>(hitResult->GetActor()->GetAttachParentActor()->GetRootComponent())->SetEnableGravity(false);
-				Cast<UPrimitiveComponent>(hitResult->GetActor()->GetAttachParentActor()->GetRootComponent())->AddImpulse(forward * (powerPush ? power : -power));
-				Cast<UPrimitiveComponent>(hitResult->GetActor()->GetAttachParentActor()->GetRootComponent())->SetEnableGravity(true);
+				keysRoot->SetEnableGravity(false);
+				keysRoot->AddImpulse(forward * (powerPush ? power : -power));
+				keysRoot->SetEnableGravity(true);
 			}
 		}
 		else {
-			if (hitResult->GetComponent()->Mobility == EComponentMobility::Movable) {
-				FString materialColision = hitResult->GetComponent()->GetMaterial(0)->GetName();
-				if (materialColision.Contains("Metal")) {
-					hitResult->GetComponent()->SetRenderCustomDepth(true);
-					hitMetalObject = true;
+			if (hitResult.GetComponent()->Mobility == EComponentMobility::Movable) {
+				if (IsMetalMaterial(hitResult.GetComponent()->GetMaterial(0))) {
+					hitMetalObject = hitResult.GetComponent();
 					if (activePowerPressed && power > 0) {
-						if (hitResult->GetComponent()->GetMass() < massLimitPower) { //Comprueba el peso del objeto
-							hitResult->GetComponent()->SetEnableGravity(false);
-							hitResult->GetComponent()->AddImpulse(forward * (powerPush ? power : -power));
-							hitResult->GetComponent()->SetEnableGravity(true);
+						if (hitResult.GetComponent()->GetMass() < massLimitPower) { //Comprueba el peso del objeto
+							hitResult.GetComponent()->SetEnableGravity(false);
+							hitResult.GetComponent()->AddImpulse(forward * (powerPush ? power : -power));
+							hitResult.GetComponent()->SetEnableGravity(true);
 						} /*else {
 							AddMovementInput(forward, (powerPush ? -power : power) / maxPower);
 						}*/
@@ -285,7 +299,7 @@ FHitResult* AHoodProjectCharacter::ActivePower() {
 		}
 	}
 
-	hitPoint = hitResult->ImpactPoint;
+	hitPoint = hitResult.ImpactPoint;
 
-	return hitMetalObject ? hitResult : nullptr;
+	return hitMetalObject;
 }
\ No newline at end of file
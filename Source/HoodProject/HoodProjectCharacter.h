@@ -7,6 +7,7 @@
 #include "HoodProjectCharacter.generated.h"
 
 class UInputComponent;
+class UMaterialInterface;
 
 UCLASS(config = Game)
 class AHoodProjectCharacter : public ACharacter
@@ -115,9 +116,14 @@ public:
 	float massLimitPower = 100.f;
 	void ChangePower();
 	void ChangePowerValue(float value);
-	FHitResult* ActivePower();
+	/*Lanza el poder y devuelve el objeto que se debe resaltar, o nullptr*/
+	UPrimitiveComponent* ActivePower();
 
-	FHitResult* lastObjectOutlined = nullptr;
+	/*Indica si el material es metalico (afectado por el poder)*/
+	static bool IsMetalMaterial(const UMaterialInterface* material);
+
+	/*Componente resaltado el ultimo frame*/
+	TWeakObjectPtr<UPrimitiveComponent> lastObjectOutlined;
 
 	bool interact = false;
 	void ChangeInteract();
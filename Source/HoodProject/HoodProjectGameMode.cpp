@@ -1,13 +1,20 @@
 // Copyright 1998-2017 Epic Games, Inc. All Rights Reserved.
 
 #include "HoodProjectGameMode.h"
+#include "HoodProject.h"
 #include "HoodProjectHUD.h"
 #include "HoodProjectCharacter.h"
+#include "HoodAnimBudgetComponent.h"
+#include "HoodNavObstacleComponent.h"
+#include "Engine/StaticMeshActor.h"
+#include "EngineUtils.h"
 #include "UObject/ConstructorHelpers.h"
 
 AHoodProjectGameMode::AHoodProjectGameMode()
 	: Super()
 {
+	HOOD_LLM_SCOPE(Gameplay);
+
 	// set default pawn class to our Blueprinted character
 	static ConstructorHelpers::FClassFinder<APawn> PlayerPawnClassFinder(TEXT("/Game/FirstPersonCPP/Blueprints/FirstPersonCharacter"));
 	DefaultPawnClass = PlayerPawnClassFinder.Class;
@@ -15,3 +22,84 @@ AHoodProjectGameMode::AHoodProjectGameMode()
 	// use our custom HUD class
 	HUDClass = AHoodProjectHUD::StaticClass();
 }
+
+void AHoodProjectGameMode::StartPlay()
+{
+	UWorld* World = GetWorld();
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		SetupActor(*It);
+	}
+	ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &AHoodProjectGameMode::SetupActor));
+
+	Super::StartPlay();
+}
+
+void AHoodProjectGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AHoodProjectGameMode::SetupActor(AActor* Actor)
+{
+	AddAnimBudget(Actor);
+	AddNavObstacle(Actor);
+}
+
+void AHoodProjectGameMode::AddAnimBudget(AActor* Actor)
+{
+	ACharacter* Character = Cast<ACharacter>(Actor);
+	if (Character == nullptr || Character->FindComponentByClass<UHoodAnimBudgetComponent>() != nullptr)
+	{
+		return;
+	}
+
+	HOOD_LLM_SCOPE(Anim);
+	UHoodAnimBudgetComponent* AnimBudget = NewObject<UHoodAnimBudgetComponent>(Character, TEXT("AnimBudget"));
+	AnimBudget->RegisterComponent();
+}
+
+void AHoodProjectGameMode::AddNavObstacle(AActor* Actor)
+{
+	if (Actor->FindComponentByClass<UHoodNavObstacleComponent>() != nullptr)
+	{
+		return;
+	}
+
+	bool bIsObstacle = !NavObstacleTag.IsNone() && Actor->ActorHasTag(NavObstacleTag);
+
+	// Metal props the player pushes around with the power
+	AStaticMeshActor* MeshActor = Cast<AStaticMeshActor>(Actor);
+	if (!bIsObstacle && MeshActor != nullptr && MeshActor->GetStaticMeshComponent()->Mobility == EComponentMobility::Movable)
+	{
+		bIsObstacle = AHoodProjectCharacter::IsMetalMaterial(MeshActor->GetStaticMeshComponent()->GetMaterial(0));
+	}
+
+	if (!bIsObstacle && NavObstacleClassPrefixes.Num() > 0)
+	{
+		const FString ClassName = Actor->GetClass()->GetName();
+		bIsObstacle = NavObstacleClassPrefixes.ContainsByPredicate([&ClassName](const FString& Prefix)
+		{
+			return ClassName.StartsWith(Prefix);
+		});
+	}
+
+	// Matinee moves them, the obstacle sees them settle, no need for NotifyMoved
+	if (!bIsObstacle && NavObstacleActorPrefixes.Num() > 0 && Actor->IsRootComponentMovable())
+	{
+		const FString ActorName = Actor->GetName();
+		bIsObstacle = NavObstacleActorPrefixes.ContainsByPredicate([&ActorName](const FString& Prefix)
+		{
+			return ActorName.StartsWith(Prefix);
+		});
+	}
+
+	if (bIsObstacle)
+	{
+		HOOD_LLM_SCOPE(Nav);
+		UHoodNavObstacleComponent* NavObstacle = NewObject<UHoodNavObstacleComponent>(Actor, TEXT("NavObstacle"));
+		NavObstacle->RegisterComponent();
+	}
+}
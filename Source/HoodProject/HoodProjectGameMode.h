@@ -13,6 +13,32 @@ class AHoodProjectGameMode : public AGameModeBase
 
 public:
 	AHoodProjectGameMode();
+
+	virtual void StartPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/* Actors whose class name starts with one of these get a nav obstacle (doors, furniture...) */
+	UPROPERTY(config, EditAnywhere, Category = "Navigation")
+		TArray<FString> NavObstacleClassPrefixes;
+
+	/* Movable actors whose name starts with one of these get a nav obstacle (bars raised by Matinee...) */
+	UPROPERTY(config, EditAnywhere, Category = "Navigation")
+		TArray<FString> NavObstacleActorPrefixes;
+
+	/* Actors with this tag always get a nav obstacle */
+	UPROPERTY(config, EditAnywhere, Category = "Navigation")
+		FName NavObstacleTag;
+
+private:
+	void SetupActor(AActor* Actor);
+
+	/** Gives characters (player and guards) an animation budget component */
+	void AddAnimBudget(AActor* Actor);
+
+	/** Gives props that move and change walkable space a nav obstacle component */
+	void AddNavObstacle(AActor* Actor);
+
+	FDelegateHandle ActorSpawnedHandle;
 };
 
 
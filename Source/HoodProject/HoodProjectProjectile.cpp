@@ -1,11 +1,14 @@
 // Copyright 1998-2017 Epic Games, Inc. All Rights Reserved.
 
 #include "HoodProjectProjectile.h"
+#include "HoodProject.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Components/SphereComponent.h"
 
 AHoodProjectProjectile::AHoodProjectProjectile() 
 {
+	HOOD_LLM_SCOPE(Gameplay);
+
 	// Use a sphere as a simple collision representation
 	CollisionComp = CreateDefaultSubobject<USphereComponent>(TEXT("SphereComp"));
 	CollisionComp->InitSphereRadius(5.0f);
@@ -2,9 +2,12 @@
 
 #include "MyWidgetComponent.h"
 #include "MyUserWidget.h"
+#include "HoodProject.h"
 
 UMyWidgetComponent::UMyWidgetComponent()
 {
+	HOOD_LLM_SCOPE(Gameplay);
+
 	// Set common defaults when using widgets on Actors
 	SetDrawAtDesiredSize(true);
 	SetWidgetSpace(EWidgetSpace::Screen);
@@ -14,6 +17,8 @@ UMyWidgetComponent::UMyWidgetComponent()
 
 void UMyWidgetComponent::InitWidget()
 {
+	HOOD_LLM_SCOPE(Gameplay);
+
 	// Base implementation creates the 'Widget' instance
 	Super::InitWidget();
 